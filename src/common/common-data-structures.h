@@ -731,6 +731,26 @@ typedef enum
 
 
 
+/*
+ *	How auto-quantization writes results back to floating-point
+ *	storage. kNewtonQuantizationStoreDefault selects the compile-time
+ *	IS_MATRIX / IS_POINTER setting from newton/config.h.
+ */
+typedef enum
+{
+	kNewtonQuantizationStoreDefault,
+	kNewtonQuantizationStoreGlobal,
+	kNewtonQuantizationStorePointer,
+	kNewtonQuantizationStoreMatrix,
+
+	/*
+	 *	Code depends on this bringing up the rear.
+	 */
+	kNewtonQuantizationStoreMax,
+} NewtonQuantizationStore;
+
+
+
 typedef enum
 {
 	/*
@@ -1389,6 +1409,15 @@ typedef struct
 	 *	LLVM IR input file
 	 */
 	char *			llvmIR;
+
+	/*
+	 *	Auto-quantization word size, fraction bits and store mode.
+	 *	Zero (kNewtonQuantizationStoreDefault) selects the compile-time
+	 *	defaults from newton/config.h.
+	 */
+	int			quantizationBitWidth;
+	int			quantizationPrecisionBits;
+	NewtonQuantizationStore	quantizationStore;
 	
 	/*
 	 *	Variables for storing lists of identifiers attached
@@ -1,6 +1,11 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+/*
+ * Defaults for auto-quantization. --llvm-ir-bit-width, --llvm-ir-precision-bits
+ * and --llvm-ir-quantization-store override them per invocation through State.
+ * */
+
 #ifndef BIT_WIDTH
 #define BIT_WIDTH 32
 #endif
@@ -112,6 +112,9 @@ main(int argc, char *argv[])
             {"llvm-ir-enable-overload",    no_argument,      0,      'o'},
             {"llvm-ir-enable-builtin-assume",    no_argument,      0,      'A'},
             {"llvm-ir-auto-quantization",    no_argument,      0,      'Q'},
+			{"llvm-ir-bit-width",	required_argument,	0,	424},
+			{"llvm-ir-precision-bits",	required_argument,	0,	425},
+			{"llvm-ir-quantization-store",	required_argument,	0,	426},
 			{"estimator-synthesis",	required_argument,	0,	420},
 			{"process",		required_argument,	0,	421},
 			{"measurement",		required_argument,	0,	422},
@@ -444,6 +447,64 @@ main(int argc, char *argv[])
                 break;
             }
 
+			case 424:
+			{
+				uint64_t tmpInt = strtoul(optarg, &ep, 0);
+				if (*ep == '\0' && (tmpInt == 16 || tmpInt == 32))
+				{
+					N->quantizationBitWidth = tmpInt;
+				}
+				else
+				{
+					usage(N);
+					consolePrintBuffers(N);
+					exit(EXIT_FAILURE);
+				}
+
+				break;
+			}
+
+			case 425:
+			{
+				uint64_t tmpInt = strtoul(optarg, &ep, 0);
+				if (*ep == '\0' && tmpInt > 0 && tmpInt < 32)
+				{
+					N->quantizationPrecisionBits = tmpInt;
+				}
+				else
+				{
+					usage(N);
+					consolePrintBuffers(N);
+					exit(EXIT_FAILURE);
+				}
+
+				break;
+			}
+
+			case 426:
+			{
+				if (!strcmp(optarg, "global"))
+				{
+					N->quantizationStore = kNewtonQuantizationStoreGlobal;
+				}
+				else if (!strcmp(optarg, "pointer"))
+				{
+					N->quantizationStore = kNewtonQuantizationStorePointer;
+				}
+				else if (!strcmp(optarg, "matrix"))
+				{
+					N->quantizationStore = kNewtonQuantizationStoreMatrix;
+				}
+				else
+				{
+					usage(N);
+					consolePrintBuffers(N);
+					exit(EXIT_FAILURE);
+				}
+
+				break;
+			}
+
 			case 494:
 			{
 				N->kernelNumber = atoi(optarg);
@@ -597,7 +658,10 @@ usage(State *  N)
 						"                | (--estimator-synthesis=<path to output file>)              \n"
 						"                | (--process=<process invariant identifier>)                 \n"
 						"                | (--measurement=<measurement invariant identifier>)         \n"
-						"                | (--auto-diff)                                      ]       \n"
+						"                | (--auto-diff)                                              \n"
+						"                | (--llvm-ir-bit-width=<16 | 32>)                            \n"
+						"                | (--llvm-ir-precision-bits=<fraction bits>)                 \n"
+						"                | (--llvm-ir-quantization-store=<global | pointer | matrix>) ]\n"
 						"                                                                             \n"
 						"              <filenames>\n\n", kNewtonL10N);
 }
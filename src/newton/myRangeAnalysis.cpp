@@ -13,6 +13,7 @@
 #include "llvm/IR/PassManager.h"
 #include "llvm/ADT/APInt.h"
 #include "Range.h"
+#include "newton-irPass-LLVMIR-bitwiseInterval.h"
 #include <map>
 #include <vector>
 
@@ -99,10 +100,15 @@ Range::Range(const APInt & lb, const APInt & ub, RangeType rType)
 }
 
 
+// 或操作，Hacker's Delight算法
 Range Range::Or(const Range &other) const {
-	APInt lower = l | other.l;
-	APInt upper = u | other.u;
-	return Range(lower, upper);
+	if (this->isUnknown() || other.isUnknown())
+	{
+		return Range(Min, Max, Unknown);
+	}
+
+	auto bounds = signedBitwiseInterval(BitwiseOr, l, u, other.l, other.u);
+	return Range(bounds.first, bounds.second);
 }
 
 // 判断是否为最大范围 [Min, Max]
@@ -484,8 +490,8 @@ Range::And(const Range & other) const
 		return Range(APInt::getNullValue(MAX_BIT_INT), umin);
 	}
 
-	APInt	      a = this->getLower();
-	APInt	      b = this->getUpper();
+	const APInt & a = this->getLower();
+	const APInt & b = this->getUpper();
 	const APInt & c = other.getLower();
 	const APInt & d = other.getUpper();
 
@@ -494,29 +500,8 @@ Range::And(const Range & other) const
 		return Range(Min, Max);
 	}
 
-	// 取反所有位
-	APInt negA = APInt(a);
-	negA.flipAllBits();
-	APInt negB = APInt(b);
-	negB.flipAllBits();
-	APInt negC = APInt(c);
-	negC.flipAllBits();
-	APInt negD = APInt(d);
-	negD.flipAllBits();
-
-	Range inv1 = Range(negB, negA);
-	Range inv2 = Range(negD, negC);
-
-	Range invres = inv1.Or(inv2);
-
-	// 取反结果
-	APInt invLower = invres.getUpper();
-	invLower.flipAllBits();
-
-	APInt invUpper = invres.getLower();
-	invUpper.flipAllBits();
-
-	return Range(invLower, invUpper);
+	auto bounds = signedBitwiseInterval(BitwiseAnd, a, b, c, d);
+	return Range(bounds.first, bounds.second);
 }
 
 // 保守的与操作，适用于大于64位的值
@@ -0,0 +1,258 @@
+/*
+ * Interval arithmetic for the bitwise operators, see
+ * newton-irPass-LLVMIR-bitwiseInterval.h.
+ */
+
+#include <assert.h>
+#include <vector>
+
+#include "newton-irPass-LLVMIR-bitwiseInterval.h"
+
+using llvm::APInt;
+
+/*
+ * lowest value of `value | mask` with all the bits below `mask` cleared,
+ * i.e. (value | mask) & -mask
+ */
+static APInt
+raiseAtBit(const APInt & value, const APInt & mask)
+{
+	APInt raised = value | mask;
+	raised &= -mask;
+	return raised;
+}
+
+static APInt
+minOr(APInt a, const APInt & b, APInt c, const APInt & d)
+{
+	for (APInt m = APInt::getSignMask(a.getBitWidth()); m != 0; m.lshrInPlace(1))
+	{
+		if ((~a & c & m) != 0)
+		{
+			APInt temp = raiseAtBit(a, m);
+			if (temp.ule(b))
+			{
+				a = temp;
+				break;
+			}
+		}
+		else if ((a & ~c & m) != 0)
+		{
+			APInt temp = raiseAtBit(c, m);
+			if (temp.ule(d))
+			{
+				c = temp;
+				break;
+			}
+		}
+	}
+	return a | c;
+}
+
+static APInt
+maxOr(const APInt & a, APInt b, const APInt & c, APInt d)
+{
+	for (APInt m = APInt::getSignMask(a.getBitWidth()); m != 0; m.lshrInPlace(1))
+	{
+		if ((b & d & m) != 0)
+		{
+			APInt temp = (b - m) | (m - 1);
+			if (temp.uge(a))
+			{
+				b = temp;
+				break;
+			}
+			temp = (d - m) | (m - 1);
+			if (temp.uge(c))
+			{
+				d = temp;
+				break;
+			}
+		}
+	}
+	return b | d;
+}
+
+static APInt
+minAnd(APInt a, const APInt & b, APInt c, const APInt & d)
+{
+	for (APInt m = APInt::getSignMask(a.getBitWidth()); m != 0; m.lshrInPlace(1))
+	{
+		if ((~a & ~c & m) != 0)
+		{
+			APInt temp = raiseAtBit(a, m);
+			if (temp.ule(b))
+			{
+				a = temp;
+				break;
+			}
+			temp = raiseAtBit(c, m);
+			if (temp.ule(d))
+			{
+				c = temp;
+				break;
+			}
+		}
+	}
+	return a & c;
+}
+
+static APInt
+maxAnd(const APInt & a, APInt b, const APInt & c, APInt d)
+{
+	for (APInt m = APInt::getSignMask(a.getBitWidth()); m != 0; m.lshrInPlace(1))
+	{
+		if ((b & ~d & m) != 0)
+		{
+			APInt temp = (b & ~m) | (m - 1);
+			if (temp.uge(a))
+			{
+				b = temp;
+				break;
+			}
+		}
+		else if ((~b & d & m) != 0)
+		{
+			APInt temp = (d & ~m) | (m - 1);
+			if (temp.uge(c))
+			{
+				d = temp;
+				break;
+			}
+		}
+	}
+	return b & d;
+}
+
+static APInt
+minXor(APInt a, const APInt & b, APInt c, const APInt & d)
+{
+	for (APInt m = APInt::getSignMask(a.getBitWidth()); m != 0; m.lshrInPlace(1))
+	{
+		if ((~a & c & m) != 0)
+		{
+			APInt temp = raiseAtBit(a, m);
+			if (temp.ule(b))
+			{
+				a = temp;
+			}
+		}
+		else if ((a & ~c & m) != 0)
+		{
+			APInt temp = raiseAtBit(c, m);
+			if (temp.ule(d))
+			{
+				c = temp;
+			}
+		}
+	}
+	return a ^ c;
+}
+
+static APInt
+maxXor(const APInt & a, APInt b, const APInt & c, APInt d)
+{
+	for (APInt m = APInt::getSignMask(a.getBitWidth()); m != 0; m.lshrInPlace(1))
+	{
+		if ((b & d & m) != 0)
+		{
+			APInt temp = (b - m) | (m - 1);
+			if (temp.uge(a))
+			{
+				b = temp;
+			}
+			else
+			{
+				temp = (d - m) | (m - 1);
+				if (temp.uge(c))
+				{
+					d = temp;
+				}
+			}
+		}
+	}
+	return b ^ d;
+}
+
+std::pair<APInt, APInt>
+unsignedBitwiseInterval(BitwiseOperator bitwiseOperator,
+			const APInt & a, const APInt & b,
+			const APInt & c, const APInt & d)
+{
+	switch (bitwiseOperator)
+	{
+		case BitwiseAnd:
+			return std::make_pair(minAnd(a, b, c, d), maxAnd(a, b, c, d));
+		case BitwiseOr:
+			return std::make_pair(minOr(a, b, c, d), maxOr(a, b, c, d));
+		case BitwiseXor:
+			return std::make_pair(minXor(a, b, c, d), maxXor(a, b, c, d));
+	}
+	assert(false && "unknown bitwise operator");
+	return std::make_pair(a, b);
+}
+
+/*
+ * split a signed interval at zero into pieces with a fixed sign bit
+ */
+static std::vector<std::pair<APInt, APInt>>
+splitAtSignBit(const APInt & low, const APInt & high)
+{
+	std::vector<std::pair<APInt, APInt>> pieces;
+	if (low.isNegative() && !high.isNegative())
+	{
+		pieces.emplace_back(low, APInt::getAllOnes(low.getBitWidth()));
+		pieces.emplace_back(APInt::getZero(low.getBitWidth()), high);
+	}
+	else
+	{
+		pieces.emplace_back(low, high);
+	}
+	return pieces;
+}
+
+std::pair<APInt, APInt>
+signedBitwiseInterval(BitwiseOperator bitwiseOperator,
+		      const APInt & a, const APInt & b,
+		      const APInt & c, const APInt & d)
+{
+	/*
+	 * within a pair of pieces the sign bits of both operands are fixed, so is the sign
+	 * bit of the result, and the unsigned order of the results is their signed order
+	 */
+	std::pair<APInt, APInt> result;
+	bool			hasResult = false;
+	for (auto & lhs : splitAtSignBit(a, b))
+	{
+		for (auto & rhs : splitAtSignBit(c, d))
+		{
+			auto piece = unsignedBitwiseInterval(bitwiseOperator, lhs.first, lhs.second,
+							     rhs.first, rhs.second);
+			if (!hasResult)
+			{
+				result	  = piece;
+				hasResult = true;
+				continue;
+			}
+			if (piece.first.slt(result.first))
+			{
+				result.first = piece.first;
+			}
+			if (piece.second.sgt(result.second))
+			{
+				result.second = piece.second;
+			}
+		}
+	}
+	return result;
+}
+
+std::pair<int64_t, int64_t>
+signedBitwiseInterval(BitwiseOperator bitwiseOperator,
+		      int64_t a, int64_t b, int64_t c, int64_t d)
+{
+	auto result = signedBitwiseInterval(bitwiseOperator,
+					    APInt(64, a, true), APInt(64, b, true),
+					    APInt(64, c, true), APInt(64, d, true));
+	return std::make_pair(result.first.getSExtValue(), result.second.getSExtValue());
+}
@@ -0,0 +1,49 @@
+/*
+ * Interval arithmetic for the bitwise operators, on whole words.
+ *
+ * The unsigned bounds are the min/max-OR, min/max-AND and min/max-XOR algorithms
+ * from Warren, "Hacker's Delight", section 4-3: each walks the bits from the most
+ * significant one down and raises a lower bound (or lowers an upper bound) at the
+ * first position where that cannot leave the interval, so a bound costs at most one
+ * pass over the bit width. The signed bounds split each interval at zero, so that
+ * every piece has a fixed sign bit, and join the unsigned results of the pieces.
+ *
+ * Shared by the range analysis of the LLVM IR passes (on int64_t) and by the
+ * APInt-based Range class.
+ */
+
+#ifndef NEWTON_IR_PASS_LLVM_IR_BITWISE_INTERVAL
+#define NEWTON_IR_PASS_LLVM_IR_BITWISE_INTERVAL
+
+#include <stdint.h>
+#include <utility>
+
+#include "llvm/ADT/APInt.h"
+
+enum BitwiseOperator {
+	BitwiseAnd = 1,
+	BitwiseOr  = 2,
+	BitwiseXor = 3,
+};
+
+/*
+ * Bounds of `x op y` for unsigned a <= x <= b and c <= y <= d.
+ */
+std::pair<llvm::APInt, llvm::APInt>
+unsignedBitwiseInterval(BitwiseOperator bitwiseOperator,
+			const llvm::APInt & a, const llvm::APInt & b,
+			const llvm::APInt & c, const llvm::APInt & d);
+
+/*
+ * Bounds of `x op y` for signed a <= x <= b and c <= y <= d.
+ */
+std::pair<llvm::APInt, llvm::APInt>
+signedBitwiseInterval(BitwiseOperator bitwiseOperator,
+		      const llvm::APInt & a, const llvm::APInt & b,
+		      const llvm::APInt & c, const llvm::APInt & d);
+
+std::pair<int64_t, int64_t>
+signedBitwiseInterval(BitwiseOperator bitwiseOperator,
+		      int64_t a, int64_t b, int64_t c, int64_t d);
+
+#endif /* NEWTON_IR_PASS_LLVM_IR_BITWISE_INTERVAL */
@@ -4,6 +4,10 @@
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/GlobalVariable.h"
 #include <vector>
+#include <map>
+#include <set>
+#include <functional>
+#include <algorithm>
 #include <cmath>
 #include "newton-irPass-LLVMIR-quantization.h"
 #include "llvm/Support/raw_ostream.h"
@@ -16,6 +20,13 @@ using namespace llvm;
 
 unsigned int FRAC_Q;
 
+/*
+ * word size of the quantized type and how results are stored back,
+ * set from State at the start of each function like FRAC_Q.
+ * */
+int			quantizationBitWidth;
+NewtonQuantizationStore quantizationStore;
+
 #define FRAC_BASE (1 << FRAC_Q)
 
 
@@ -24,7 +35,7 @@ performFixedPointMul(llvm::IRBuilder<> & Builder, llvm::Value * lhs, llvm::Value
 {
 	llvm::Value * result = nullptr;
 
-	switch (BIT_WIDTH)
+	switch (quantizationBitWidth)
 	{
 		case 16:
 		{
@@ -63,7 +74,7 @@ performFixedPointMul(llvm::IRBuilder<> & Builder, llvm::Value * lhs, llvm::Value
 		}
 		default:
 		{
-			llvm::errs() << "Unsupported BIT_WIDTH: " << BIT_WIDTH << "\n";
+			llvm::errs() << "Unsupported BIT_WIDTH: " << quantizationBitWidth << "\n";
 			break;
 		}
 	}
@@ -71,70 +82,452 @@ performFixedPointMul(llvm::IRBuilder<> & Builder, llvm::Value * lhs, llvm::Value
 	return result;
 }
 
+/*
+ * Per-value fixed-point format, as the number of fraction bits of each quantized value.
+ * Values that are not in the map use the function-wide FRAC_Q, which is also the format
+ * of arguments, loads, stores, calls and everything else outside FAdd/FSub/FMul/PHI.
+ * */
+std::map<llvm::Value *, int> fixedPointFormat;
+
+int
+getFixedPointFormat(llvm::Value * value)
+{
+	auto formatIt = fixedPointFormat.find(value);
+	return formatIt == fixedPointFormat.end() ? (int)FRAC_Q : formatIt->second;
+}
+
+/*
+ * remove the format of an instruction that is about to be replaced,
+ * so that a new instruction allocated at the same address does not inherit it.
+ * */
+int
+takeFixedPointFormat(llvm::Value * value)
+{
+	int fracBits = getFixedPointFormat(value);
+	fixedPointFormat.erase(value);
+	return fracBits;
+}
+
+void
+setFixedPointFormat(llvm::Value * value, int fracBits)
+{
+	if (isa<Instruction>(value) && fracBits != (int)FRAC_Q)
+	{
+		fixedPointFormat[value] = fracBits;
+	}
+}
+
+/*
+ * shift a quantized value from `fromFracBits` to `toFracBits` fraction bits.
+ * */
+llvm::Value *
+alignFixedPoint(llvm::IRBuilder<> & Builder, llvm::Value * value, int fromFracBits, int toFracBits)
+{
+	if (fromFracBits == toFracBits || !value->getType()->isIntegerTy())
+	{
+		return value;
+	}
+	if (fromFracBits > toFracBits)
+	{
+		return Builder.CreateAShr(value, ConstantInt::get(value->getType(), fromFracBits - toFracBits));
+	}
+	return Builder.CreateShl(value, ConstantInt::get(value->getType(), toFracBits - fromFracBits));
+}
+
+llvm::Value *
+quantizeConstantFP(ConstantFP * constFp, Type * quantizedType, int fracBits)
+{
+	double	constValue     = constFp->getValueAPF().convertToDouble();
+	int64_t quantizedValue = static_cast<int64_t>(round(ldexp(constValue, fracBits)));
+	return ConstantInt::get(quantizedType, quantizedValue, true);
+}
+
+/*
+ * Only these users align their operands to the format they expect;
+ * a value with any other user keeps FRAC_Q.
+ * */
+bool
+isFixedPointFormatAware(llvm::Value * value)
+{
+	auto * llvmIrInstruction = dyn_cast<Instruction>(value);
+	if (llvmIrInstruction == nullptr || !llvmIrInstruction->getType()->isFloatingPointTy())
+	{
+		return false;
+	}
+	switch (llvmIrInstruction->getOpcode())
+	{
+		case Instruction::FAdd:
+		case Instruction::FSub:
+		case Instruction::PHI:
+			return true;
+		case Instruction::FMul:
+			/*
+			 * multiplication by a constant is rewritten to shifts or integer
+			 * multiplication, which keep the format of the other operand.
+			 * */
+			return !isa<llvm::Constant>(llvmIrInstruction->getOperand(0)) &&
+			       !isa<llvm::Constant>(llvmIrInstruction->getOperand(1));
+		default:
+			return false;
+	}
+}
+
+/*
+ * the most fraction bits that still keep max(|lowerBound|, |upperBound|) inside a signed `bitWidth`-bit integer.
+ * */
+int
+selectFracBits(double lowerBound, double upperBound, int bitWidth)
+{
+	double maxAbs	= std::max(fabs(lowerBound), fabs(upperBound));
+	int    fracBits = bitWidth - 2;
+	if (maxAbs > 0)
+	{
+		fracBits = bitWidth - 2 - (int)floor(log2(maxAbs));
+	}
+	return std::min(std::max(fracBits, 0), bitWidth - 2);
+}
+
 extern "C" {
-// TODO : float version rsqrt
-llvm::Function *
-createFixSqrt(llvm::Module * irModule, Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert)
+
+/*
+ * the quantization options of this invocation, falling back to the defaults in config.h.
+ * */
+int
+getQuantizationBitWidth(State * N)
 {
-	if (!irModule)
+	return N->quantizationBitWidth != 0 ? N->quantizationBitWidth : BIT_WIDTH;
+}
+
+int
+getQuantizationPrecisionBits(State * N)
+{
+	return N->quantizationPrecisionBits != 0 ? N->quantizationPrecisionBits : MAX_PRECISION_BITS;
+}
+
+NewtonQuantizationStore
+getQuantizationStore(State * N)
+{
+	if (N->quantizationStore != kNewtonQuantizationStoreDefault)
 	{
-		llvm::errs() << "Error: irModule is nullptr\n";
-		return nullptr;
+		return N->quantizationStore;
 	}
+#if IS_MATRIX
+	return kNewtonQuantizationStoreMatrix;
+#elif IS_POINTER
+	return kNewtonQuantizationStorePointer;
+#else
+	return kNewtonQuantizationStoreGlobal;
+#endif
+}
 
-	std::string fixSqrtFuncName = "fixsqrt";
-	for (auto & function : *irModule)
+void
+selectFixedPointFormats(llvm::Function & llvmIrFunction, BoundInfo * boundInfo, int bitWidth, int maxPrecisionBits,
+			std::map<llvm::Value *, int> & formats)
+{
+	if (boundInfo == nullptr)
 	{
-		if (function.getName() == fixSqrtFuncName)
+		return;
+	}
+
+	std::vector<Instruction *> candidates;
+	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
+	{
+		for (Instruction & llvmIrInstruction : llvmIrBasicBlock)
 		{
-			llvm::errs() << "fixsqrt already exists\n";
-			return &function;
+			if (!isFixedPointFormatAware(&llvmIrInstruction))
+			{
+				continue;
+			}
+			auto rangeIt = boundInfo->virtualRegisterRange.find(&llvmIrInstruction);
+			if (rangeIt == boundInfo->virtualRegisterRange.end() ||
+			    !std::isfinite(rangeIt->second.first) || !std::isfinite(rangeIt->second.second))
+			{
+				continue;
+			}
+			bool allUsersAware = true;
+			for (User * llvmIrUser : llvmIrInstruction.users())
+			{
+				allUsersAware &= isFixedPointFormatAware(llvmIrUser);
+			}
+			if (!allUsersAware)
+			{
+				continue;
+			}
+			formats[&llvmIrInstruction] = selectFracBits(rangeIt->second.first, rangeIt->second.second, bitWidth);
+			candidates.push_back(&llvmIrInstruction);
 		}
 	}
 
-	llvm::LLVMContext &  context  = irModule->getContext();
-	llvm::FunctionType * funcType = llvm::FunctionType::get(quantizedType, {quantizedType}, false);
-	llvm::Function *     func     = llvm::Function::Create(funcType, llvm::Function::PrivateLinkage, fixSqrtFuncName, irModule);
-	llvm::BasicBlock *   entryBB  = llvm::BasicBlock::Create(context, "entry", func);
-	llvm::IRBuilder<>    builder(entryBB);
+	/*
+	 * A PHI cannot hold more fraction bits than its incoming values carry, and a product
+	 * cannot have more than the sum of its operands'. Lowering only ever decreases the
+	 * formats, so this terminates.
+	 * */
+	auto formatOf = [&](Value * value) {
+		if (isa<llvm::Constant>(value))
+		{
+			return bitWidth - 2;
+		}
+		auto formatIt = formats.find(value);
+		return formatIt == formats.end() ? maxPrecisionBits : formatIt->second;
+	};
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (Instruction * llvmIrInstruction : candidates)
+		{
+			int fracBits = formats[llvmIrInstruction];
+			if (auto * phi = dyn_cast<PHINode>(llvmIrInstruction))
+			{
+				for (Value * incoming : phi->incoming_values())
+				{
+					fracBits = std::min(fracBits, formatOf(incoming));
+				}
+			}
+			else if (llvmIrInstruction->getOpcode() == Instruction::FMul)
+			{
+				fracBits = std::min(fracBits, formatOf(llvmIrInstruction->getOperand(0)) +
+								  formatOf(llvmIrInstruction->getOperand(1)));
+			}
+			if (fracBits < formats[llvmIrInstruction])
+			{
+				formats[llvmIrInstruction] = fracBits;
+				changed			   = true;
+			}
+		}
+	}
+}
 
-	llvm::Function::arg_iterator args = func->arg_begin();
-	llvm::Value *		     x	  = &*args++;
+/*
+ * Integer-only math kernels. Each is emitted once per module as a private function that
+ * takes and returns the quantized type in the FRAC_Q format. They compute in a word twice as wide
+ * as the quantized type, so only 16- and 32-bit quantization use them; other widths keep
+ * the float conversions. The operand interval of each call decides how much work its kernel does.
+ * */
+enum MathKernelConfig
+{
+	/*
+	 * sin/cos run CORDIC on a 32-bit word with this many fraction bits,
+	 * which still holds +-pi.
+	 * */
+	CordicFracBits = 29,
+	/*
+	 * upper bound on Newton iterations for rsqrt
+	 * */
+	MaxRsqrtIterations = 6,
+};
+
+/*
+ * how much range reduction sin/cos need before CORDIC, from the operand interval
+ * */
+typedef enum
+{
+	SinCosReductionNone,	/* operand within [-pi/2, pi/2] */
+	SinCosReductionFold,	/* operand within [-pi, pi] */
+	SinCosReductionWrap,	/* anything else */
+} SinCosReduction;
 
-	// Convert the fixed-point integer to a floating-point number for sqrt computation
-	llvm::Value * fp_x = builder.CreateSIToFP(x, llvm::Type::getFloatTy(context));
+/*
+ * operand interval of each sqrt/sin/cos/invSqrt call in the function being quantized,
+ * collected before any instruction is replaced.
+ * */
+std::map<llvm::Value *, std::pair<double, double>> mathCallOperandRange;
 
-	// Call sqrt on the floating-point value
-	llvm::Function * sqrtFunc   = llvm::Intrinsic::getDeclaration(irModule, llvm::Intrinsic::sqrt, llvm::Type::getFloatTy(context));
-	llvm::Value *	 sqrtResult = builder.CreateCall(sqrtFunc, {fp_x});
+bool
+hasIntegerMathKernels(Type * quantizedType)
+{
+	return quantizedType->isIntegerTy(16) || quantizedType->isIntegerTy(32);
+}
 
-	// Convert the result back to a fixed-point integer
-	llvm::Value * res = builder.CreateFPToSI(sqrtResult, quantizedType);
+bool
+getMathCallOperandRange(llvm::Value * llvmIrCallInstruction, double & lowerBound, double & upperBound)
+{
+	auto rangeIt = mathCallOperandRange.find(llvmIrCallInstruction);
+	if (rangeIt == mathCallOperandRange.end() ||
+	    !std::isfinite(rangeIt->second.first) || !std::isfinite(rangeIt->second.second))
+	{
+		return false;
+	}
+	lowerBound = rangeIt->second.first;
+	upperBound = rangeIt->second.second;
+	return true;
+}
 
-	// Perform a left shift to scale the result
-	llvm::Value * shlRes = builder.CreateShl(res, FRAC_Q / 2);
+void
+collectMathCallOperandRanges(llvm::Function & llvmIrFunction, BoundInfo * boundInfo)
+{
+	static const std::set<std::string> mathFunctions = {
+	    "sqrt", "sqrtf", "sin", "sinf", "cos", "cosf", "invSqrt"};
 
-	// Apply compensation if FRAC_Q is odd
-	llvm::Value * finalRes = shlRes;
-	if (FRAC_Q % 2 != 0)
+	mathCallOperandRange.clear();
+	if (boundInfo == nullptr)
+	{
+		return;
+	}
+	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
+	{
+		for (Instruction & llvmIrInstruction : llvmIrBasicBlock)
+		{
+			auto * llvmIrCallInstruction = dyn_cast<CallInst>(&llvmIrInstruction);
+			if (llvmIrCallInstruction == nullptr || llvmIrCallInstruction->arg_size() == 0 ||
+			    llvmIrCallInstruction->getCalledFunction() == nullptr ||
+			    mathFunctions.find(llvmIrCallInstruction->getCalledFunction()->getName().str()) == mathFunctions.end())
+			{
+				continue;
+			}
+			auto rangeIt = boundInfo->virtualRegisterRange.find(llvmIrCallInstruction->getArgOperand(0));
+			if (rangeIt != boundInfo->virtualRegisterRange.end())
+			{
+				mathCallOperandRange[llvmIrCallInstruction] = rangeIt->second;
+			}
+		}
+	}
+}
+
+llvm::Function *
+getOrCreateMathKernel(llvm::Module * irModule, const std::string & kernelName, llvm::Type * quantizedType,
+		      std::vector<llvm::Function *> & functionsToInsert,
+		      const std::function<llvm::Value *(llvm::IRBuilder<> &, llvm::Value *)> & emitBody)
+{
+	if (llvm::Function * existing = irModule->getFunction(kernelName))
 	{
-		llvm::Value * compensationFactor = llvm::ConstantFP::get(llvm::Type::getFloatTy(context), 1.414213562);
-		llvm::Value * fpShlRes		 = builder.CreateSIToFP(shlRes, llvm::Type::getFloatTy(context));
-		llvm::Value * compensated	 = builder.CreateFMul(fpShlRes, compensationFactor);
-		finalRes			 = builder.CreateFPToSI(compensated, quantizedType);
+		return existing;
 	}
 
-	builder.CreateRet(finalRes);
+	llvm::FunctionType * funcType = llvm::FunctionType::get(quantizedType, {quantizedType}, false);
+	llvm::Function *     func     = llvm::Function::Create(funcType, llvm::Function::PrivateLinkage, kernelName, irModule);
+	llvm::BasicBlock *   entryBB  = llvm::BasicBlock::Create(irModule->getContext(), "entry", func);
+	llvm::IRBuilder<>    builder(entryBB);
+
+	builder.CreateRet(emitBody(builder, &*func->arg_begin()));
 	functionsToInsert.push_back(func);
-	llvm::errs() << "Created fixsqrt function: " << func->getName() << "\n";
+	llvm::errs() << "Created math kernel: " << kernelName << "\n";
 
 	return func;
 }
 
+/*
+ * digit-by-digit square root of (x << FRAC_Q), which is sqrt(x) in the same format.
+ * `startBit` is the highest even bit the radicand can reach; the loop is unrolled
+ * into one compare-and-select step per result bit.
+ * */
+llvm::Value *
+emitFixSqrt(llvm::IRBuilder<> & builder, llvm::Value * x, int startBit)
+{
+	unsigned	    wordBits = x->getType()->getIntegerBitWidth();
+	llvm::IntegerType * wideType = llvm::IntegerType::get(builder.getContext(), 2 * wordBits);
+
+	llvm::Value * radicand = builder.CreateSExt(x, wideType);
+	llvm::Value * zero     = llvm::ConstantInt::get(wideType, 0);
+	radicand	       = builder.CreateSelect(builder.CreateICmpSLT(radicand, zero), zero, radicand);
+	radicand	       = builder.CreateShl(radicand, FRAC_Q);
+
+	llvm::Value * root = zero;
+	for (int bit = startBit; bit >= 0; bit -= 2)
+	{
+		llvm::Value * one	= llvm::ConstantInt::get(wideType, 1ULL << bit);
+		llvm::Value * trial	= builder.CreateAdd(root, one);
+		llvm::Value * fits	= builder.CreateICmpUGE(radicand, trial);
+		llvm::Value * halfRoot	= builder.CreateLShr(root, 1);
+		radicand		= builder.CreateSelect(fits, builder.CreateSub(radicand, trial), radicand);
+		root			= builder.CreateSelect(fits, builder.CreateAdd(halfRoot, one), halfRoot);
+	}
+
+	return builder.CreateTrunc(root, x->getType());
+}
 
+llvm::Function *
+createFixSqrt(llvm::Module * irModule, Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert,
+	      llvm::Value * llvmIrCallInstruction)
+{
+	if (!irModule)
+	{
+		llvm::errs() << "Error: irModule is nullptr\n";
+		return nullptr;
+	}
+
+	/*
+	 * the radicand is below 2^(wordBits - 1 + FRAC_Q), or below upperBound * 2^(2 * FRAC_Q)
+	 * when the operand interval is known.
+	 * */
+	unsigned wordBits = quantizedType->getIntegerBitWidth();
+	int	 topBit	  = wordBits - 2 + FRAC_Q;
+	double	 lowerBound, upperBound;
+	if (getMathCallOperandRange(llvmIrCallInstruction, lowerBound, upperBound) && upperBound > 0)
+	{
+		topBit = std::min(topBit, (int)floor(log2(ldexp(upperBound, 2 * FRAC_Q))));
+	}
+	int startBit = std::max(topBit, 0) & ~1;
+
+	std::string kernelName = "fixsqrt_q" + std::to_string(FRAC_Q) + "_" + std::to_string(startBit);
+	return getOrCreateMathKernel(irModule, kernelName, quantizedType, functionsToInsert,
+				     [&](llvm::IRBuilder<> & builder, llvm::Value * x) {
+					     return emitFixSqrt(builder, x, startBit);
+				     });
+}
+
+/*
+ * relative error of a Newton step for 1/sqrt(x), when the previous estimate was off by `error`
+ * */
+double
+nextRsqrtError(double error)
+{
+	return fabs(1.5 * error * error - 0.5 * error * error * error);
+}
+
+/*
+ * 1/sqrt(x) by Newton's method y = y * (3 - x * y * y) / 2, entirely in integers.
+ * With `initialGuess` zero, the first estimate is the power of two from the leading-zero
+ * count of x, which is within a factor of sqrt(2).
+ * */
+llvm::Value *
+emitFixRsqrt(llvm::IRBuilder<> & builder, llvm::Value * x, int64_t initialGuess, int iterations)
+{
+	unsigned	    wordBits = x->getType()->getIntegerBitWidth();
+	llvm::IntegerType * wideType = llvm::IntegerType::get(builder.getContext(), 2 * wordBits);
+
+	llvm::Value * wideX = builder.CreateSExt(x, wideType);
+	llvm::Value * y	    = nullptr;
+	if (initialGuess != 0)
+	{
+		y = llvm::ConstantInt::get(wideType, initialGuess);
+	}
+	else
+	{
+		/*
+		 * x has `bitLength` bits, so its value is about 2^(bitLength - 1 - FRAC_Q)
+		 * and 1/sqrt(x) is about 2^((3 * FRAC_Q + 1 - bitLength) / 2) in raw units.
+		 * */
+		llvm::Function * ctlz	   = llvm::Intrinsic::getDeclaration(builder.GetInsertBlock()->getModule(), llvm::Intrinsic::ctlz, {wideType});
+		llvm::Value *	 bitLength = builder.CreateSub(llvm::ConstantInt::get(wideType, 2 * wordBits),
+							       builder.CreateCall(ctlz, {wideX, builder.getFalse()}));
+		llvm::Value *	 shift	   = builder.CreateAShr(builder.CreateSub(llvm::ConstantInt::get(wideType, 3 * FRAC_Q + 1), bitLength), 1);
+		llvm::Value *	 zero	   = llvm::ConstantInt::get(wideType, 0);
+		shift			   = builder.CreateSelect(builder.CreateICmpSLT(shift, zero), zero, shift);
+		y			   = builder.CreateShl(llvm::ConstantInt::get(wideType, 1), shift);
+	}
+
+	llvm::Value * three = llvm::ConstantInt::get(wideType, 3ULL << FRAC_Q);
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		llvm::Value * xy  = builder.CreateAShr(builder.CreateMul(wideX, y), FRAC_Q);
+		llvm::Value * xyy = builder.CreateAShr(builder.CreateMul(xy, y), FRAC_Q);
+		y		  = builder.CreateAShr(builder.CreateMul(y, builder.CreateSub(three, xyy)), FRAC_Q + 1);
+	}
+
+	/*
+	 * saturate: non-positive inputs and results above the word's range give its maximum
+	 * */
+	llvm::Value * maxValue = llvm::ConstantInt::get(wideType, (1ULL << (wordBits - 1)) - 1);
+	llvm::Value * overflow = builder.CreateOr(builder.CreateICmpSLE(wideX, llvm::ConstantInt::get(wideType, 0)),
+						  builder.CreateICmpSGT(y, maxValue));
+	return builder.CreateTrunc(builder.CreateSelect(overflow, maxValue, y), x->getType());
+}
 
 llvm::Function *
-createFixRsqrt(llvm::Module * irModule, llvm::Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert)
+createFixRsqrt(llvm::Module * irModule, llvm::Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert,
+	       llvm::Value * llvmIrCallInstruction)
 {
 	llvm::errs() << "Entering createFixRsqrt\n";
 
@@ -145,107 +538,147 @@ createFixRsqrt(llvm::Module * irModule, llvm::Type * quantizedType, std::vector<
 		return nullptr;
 	}
 
-	std::string fixrsqrtFuncName = "fixrsqrt";
-	for (auto & function : *irModule)
-	{
-		if (function.getName() == fixrsqrtFuncName)
+	/*
+	 * A positive operand interval [lo, hi] allows a constant first estimate 1/sqrt(sqrt(lo * hi)),
+	 * off by at most (hi / lo)^(1/4). It replaces the leading-zero estimate when that is closer.
+	 * The iteration count is the number of Newton steps that bring the worse of the two error signs below
+	 * half an ulp of FRAC_Q.
+	 * */
+	double	lowerBound, upperBound;
+	int64_t initialGuess  = 0;
+	double	overestimate  = sqrt(2.0) - 1;
+	double	underestimate = 1 - 1 / sqrt(2.0);
+	if (getMathCallOperandRange(llvmIrCallInstruction, lowerBound, upperBound) && lowerBound > 0)
+	{
+		double ratio = pow(upperBound / lowerBound, 0.25);
+		if (ratio - 1 < overestimate)
 		{
-			llvm::errs() << "fixrsqrt already exists\n";
-			return &function;
+			initialGuess  = (int64_t)round(ldexp(1 / sqrt(sqrt(lowerBound * upperBound)), FRAC_Q));
+			overestimate  = ratio - 1;
+			underestimate = 1 - 1 / ratio;
 		}
 	}
+	int    iterations = 0;
+	double error	  = std::max(nextRsqrtError(-overestimate), nextRsqrtError(underestimate));
+	for (iterations = 1; iterations < MaxRsqrtIterations && error > ldexp(1.0, -(int)FRAC_Q - 1); iterations++)
+	{
+		error = nextRsqrtError(error);
+	}
 
-	// Define the function type: int16_t/int32_t fixrsqrt(int16_t/int32_t x)
-	llvm::FunctionType * funcType = llvm::FunctionType::get(quantizedType, {quantizedType}, false);
-	llvm::Function *     func     = llvm::Function::Create(funcType, llvm::Function::PrivateLinkage, fixrsqrtFuncName, irModule);
-
-	llvm::BasicBlock * entryBB = llvm::BasicBlock::Create(irModule->getContext(), "", func);
-	llvm::IRBuilder<>  builder(entryBB);
+	std::string kernelName = initialGuess == 0 ? "fixrsqrt"
+						   : "fixrsqrt_q" + std::to_string(FRAC_Q) + "_" + std::to_string(initialGuess) +
+							 "_" + std::to_string(iterations);
+	return getOrCreateMathKernel(irModule, kernelName, quantizedType, functionsToInsert,
+				     [&](llvm::IRBuilder<> & builder, llvm::Value * x) {
+					     return emitFixRsqrt(builder, x, initialGuess, iterations);
+				     });
+}
 
-	// Get the function argument (x)
-	llvm::Function::arg_iterator args = func->arg_begin();
-	llvm::Value *		     x	  = &*args++;
+/*
+ * sin or cos by CORDIC rotation with `iterations` unrolled steps. The angle is first reduced
+ * to [-pi, pi] (SinCosReductionWrap), folded to [-pi/2, pi/2] (SinCosReductionFold), and moved
+ * to CordicFracBits fraction bits; the result comes back in FRAC_Q.
+ * */
+llvm::Value *
+emitFixSinCos(llvm::IRBuilder<> & builder, llvm::Value * x, bool isSin, int iterations, SinCosReduction reduction)
+{
+	unsigned	    wordBits   = x->getType()->getIntegerBitWidth();
+	llvm::IntegerType * cordicType = builder.getInt32Ty();
+	llvm::IntegerType * wideType   = llvm::IntegerType::get(builder.getContext(), 2 * wordBits);
 
-	llvm::Value *fpX = nullptr, *scaledFpX = nullptr, *approx = nullptr, *intApprox = nullptr, *shiftedX = nullptr, *result = nullptr;
+	llvm::Value * angle = builder.CreateSExt(x, wideType);
+	if (reduction == SinCosReductionWrap)
+	{
+		/*
+		 * angle -= round(angle / 2pi) * 2pi, with the division rounding half away from zero
+		 * */
+		llvm::Value * pi     = llvm::ConstantInt::get(wideType, (int64_t)round(ldexp(M_PI, FRAC_Q)), true);
+		llvm::Value * minusPi = llvm::ConstantInt::get(wideType, -(int64_t)round(ldexp(M_PI, FRAC_Q)), true);
+		llvm::Value * twoPi  = llvm::ConstantInt::get(wideType, (int64_t)round(ldexp(2 * M_PI, FRAC_Q)), true);
+		llvm::Value * offset = builder.CreateSelect(builder.CreateICmpSGE(angle, llvm::ConstantInt::get(wideType, 0)), pi, minusPi);
+		llvm::Value * turns  = builder.CreateSDiv(builder.CreateAdd(angle, offset), twoPi);
+		angle		     = builder.CreateSub(angle, builder.CreateMul(turns, twoPi));
+	}
+	angle = builder.CreateSExtOrTrunc(angle, cordicType);
+	angle = FRAC_Q <= CordicFracBits ? builder.CreateShl(angle, CordicFracBits - FRAC_Q)
+					 : builder.CreateAShr(angle, FRAC_Q - CordicFracBits);
+
+	llvm::Value * negateCos = builder.getFalse();
+	if (reduction != SinCosReductionNone)
+	{
+		llvm::Value * halfPi	  = llvm::ConstantInt::get(cordicType, (int64_t)round(ldexp(M_PI / 2, CordicFracBits)), true);
+		llvm::Value * minusHalfPi = llvm::ConstantInt::get(cordicType, -(int64_t)round(ldexp(M_PI / 2, CordicFracBits)), true);
+		llvm::Value * pi	  = llvm::ConstantInt::get(cordicType, (int64_t)round(ldexp(M_PI, CordicFracBits)), true);
+		llvm::Value * minusPi	  = llvm::ConstantInt::get(cordicType, -(int64_t)round(ldexp(M_PI, CordicFracBits)), true);
+		llvm::Value * above	  = builder.CreateICmpSGT(angle, halfPi);
+		llvm::Value * below	  = builder.CreateICmpSLT(angle, minusHalfPi);
+		angle			  = builder.CreateSelect(above, builder.CreateSub(pi, angle),
+								 builder.CreateSelect(below, builder.CreateSub(minusPi, angle), angle));
+		negateCos		  = builder.CreateOr(above, below);
+	}
+
+	/*
+	 * start from (1/K, 0) so that the CORDIC gain K cancels
+	 * */
+	double gain = 1;
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		gain *= sqrt(1 + ldexp(1.0, -2 * iteration));
+	}
+	llvm::Value * cosine = llvm::ConstantInt::get(cordicType, (int64_t)round(ldexp(1 / gain, CordicFracBits)), true);
+	llvm::Value * sine   = llvm::ConstantInt::get(cordicType, 0);
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		llvm::Value * arctan	   = llvm::ConstantInt::get(cordicType, (int64_t)round(ldexp(atan(ldexp(1.0, -iteration)), CordicFracBits)), true);
+		llvm::Value * nonNegative  = builder.CreateICmpSGE(angle, llvm::ConstantInt::get(cordicType, 0));
+		llvm::Value * shiftedCos   = builder.CreateAShr(cosine, iteration);
+		llvm::Value * shiftedSin   = builder.CreateAShr(sine, iteration);
+		llvm::Value * nextCosine   = builder.CreateSelect(nonNegative, builder.CreateSub(cosine, shiftedSin), builder.CreateAdd(cosine, shiftedSin));
+		sine			   = builder.CreateSelect(nonNegative, builder.CreateAdd(sine, shiftedCos), builder.CreateSub(sine, shiftedCos));
+		cosine			   = nextCosine;
+		angle			   = builder.CreateSelect(nonNegative, builder.CreateSub(angle, arctan), builder.CreateAdd(angle, arctan));
+	}
+
+	llvm::Value * result = sine;
+	if (!isSin)
+	{
+		result = builder.CreateSelect(negateCos, builder.CreateNeg(cosine), cosine);
+	}
+	result = FRAC_Q <= CordicFracBits ? builder.CreateAShr(result, CordicFracBits - FRAC_Q)
+					  : builder.CreateShl(builder.CreateSExt(result, wideType), FRAC_Q - CordicFracBits);
+	return builder.CreateSExtOrTrunc(result, x->getType());
+}
 
-	// Switch based on BIT_WIDTH
-	switch (BIT_WIDTH)
+llvm::Function *
+createFixSinCos(llvm::Module * irModule, llvm::Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert,
+		llvm::Value * llvmIrCallInstruction, bool isSin)
+{
+	SinCosReduction reduction = SinCosReductionWrap;
+	double		lowerBound, upperBound;
+	if (getMathCallOperandRange(llvmIrCallInstruction, lowerBound, upperBound))
 	{
-		case 16:
+		double maxAbs = std::max(fabs(lowerBound), fabs(upperBound));
+		if (maxAbs <= M_PI / 2)
 		{
-			// Step 1: Shift x to compute %1 (x >> 1)
-			shiftedX = builder.CreateAShr(x, llvm::ConstantInt::get(quantizedType, 1));
-
-			// Step 2: Convert x to float and scale
-			llvm::Value * sextX = builder.CreateSExt(x, llvm::Type::getInt32Ty(irModule->getContext()));
-			fpX		    = builder.CreateSIToFP(sextX, llvm::Type::getFloatTy(irModule->getContext()));
-			scaledFpX	    = builder.CreateFMul(fpX, llvm::ConstantFP::get(llvm::Type::getFloatTy(irModule->getContext()), 1.0f / FRAC_BASE));
-
-			// Step 3: Approximation using magic number
-			llvm::Value * bitcastFpX   = builder.CreateBitCast(scaledFpX, llvm::Type::getInt32Ty(irModule->getContext()));
-			llvm::Value * shiftedFpX   = builder.CreateLShr(bitcastFpX, 1);
-//						llvm::Value * shiftedFpX   = builder.CreateAShr(bitcastFpX, 1);
-			llvm::Value * magicNumber  = llvm::ConstantInt::get(llvm::Type::getInt32Ty(irModule->getContext()), 0x5f3759df);
-			approx			   = builder.CreateSub(magicNumber, shiftedFpX);
-			llvm::Value * approxFp	   = builder.CreateBitCast(approx, llvm::Type::getFloatTy(irModule->getContext()));
-			llvm::Value * scaledApprox = builder.CreateFMul(approxFp, llvm::ConstantFP::get(llvm::Type::getFloatTy(irModule->getContext()), FRAC_BASE));
-			intApprox		   = builder.CreateFPToSI(scaledApprox, llvm::Type::getInt32Ty(irModule->getContext()));
-
-			// Step 4: Newton-Raphson refinement
-			llvm::Value * sextShiftedX = builder.CreateSExt(shiftedX, llvm::Type::getInt32Ty(irModule->getContext()));
-			llvm::Value * mul1	   = builder.CreateMul(sextShiftedX, intApprox);
-			llvm::Value * mul1Shifted  = builder.CreateLShr(mul1, FRAC_Q);
-//						llvm::Value * mul1Shifted  = builder.CreateAShr(mul1, FRAC_Q);
-
-			llvm::Value * mul2	  = builder.CreateMul(mul1Shifted, intApprox);
-			//			llvm::Value * mul2Shifted = builder.CreateLShr(mul2, FRAC_Q);
-			llvm::Value * mul2Shifted = builder.CreateAShr(mul2, FRAC_Q);
-
-			int	      correctionValue = static_cast<int>(1.5f * FRAC_BASE);
-			llvm::Value * correction      = builder.CreateSub(
-				 llvm::ConstantInt::get(llvm::Type::getInt32Ty(irModule->getContext()), correctionValue),
-				 mul2Shifted);
-			llvm::Value * finalMul	   = builder.CreateMul(intApprox, correction);
-			llvm::Value * finalShifted = builder.CreateLShr(finalMul, FRAC_Q);
-//						llvm::Value * finalShifted = builder.CreateAShr(finalMul, FRAC_Q);
-
-			// Step 5: Truncate the result back to i16
-			result = builder.CreateTrunc(finalShifted, quantizedType);
-			break;
+			reduction = SinCosReductionNone;
 		}
-		case 32:
-		default:
+		else if (maxAbs <= M_PI)
 		{
-			// Step 1: Shift x to compute %1 (x >> 1)
-//			llvm::Value * halfBase = builder.CreateLShr(x, llvm::ConstantInt::get(quantizedType, 1));
-						llvm::Value * halfBase = builder.CreateAShr(x, llvm::ConstantInt::get(quantizedType, 1));
-
-			// Step 2: Convert x to floating-point and perform the initial approximation
-			fpX = builder.CreateSIToFP(x, llvm::Type::getFloatTy(irModule->getContext()));
-			fpX = builder.CreateFMul(fpX, llvm::ConstantFP::get(llvm::Type::getFloatTy(irModule->getContext()), 1.0f / FRAC_BASE));
-
-			//			llvm::Value * i = builder.CreateBitCast(fpX, llvm::Type::getInt32Ty(irModule->getContext()));
-			llvm::Value * i = builder.CreateBitCast(fpX, llvm::Type::getInt32Ty(irModule->getContext()));
-			//			i		= builder.CreateNSWSub(llvm::ConstantInt::get(llvm::Type::getInt32Ty(irModule->getContext()), 0x5f3759df), builder.CreateLShr(i, 1));
-			i		= builder.CreateNSWSub(llvm::ConstantInt::get(llvm::Type::getInt32Ty(irModule->getContext()), 0x5f3759df), builder.CreateAShr(i, 1));
-			fpX		= builder.CreateBitCast(i, llvm::Type::getFloatTy(irModule->getContext()));
-
-			llvm::Value * int_y	 = builder.CreateFPToSI(builder.CreateFMul(fpX, llvm::ConstantFP::get(llvm::Type::getFloatTy(irModule->getContext()), FRAC_BASE)), quantizedType);
-			llvm::Value * mulfix1	 = performFixedPointMul(builder, halfBase, int_y, FRAC_Q);
-			llvm::Value * mulfix2	 = performFixedPointMul(builder, mulfix1, int_y, FRAC_Q);
-			llvm::Value * correction = builder.CreateSub(llvm::ConstantInt::get(quantizedType, static_cast<int>(1.5f * FRAC_BASE)), mulfix2);
-			llvm::Value * final_y	 = performFixedPointMul(builder, int_y, correction, FRAC_Q);
-
-			result = final_y;
-			break;
+			reduction = SinCosReductionFold;
 		}
 	}
 
-	// Return the result
-	builder.CreateRet(result);
-	functionsToInsert.emplace_back(func);
+	/*
+	 * each CORDIC step adds about one bit, so stop once it passes FRAC_Q
+	 * */
+	int iterations = std::min((int)FRAC_Q + 2, (int)CordicFracBits);
 
-	return func;
+	std::string kernelName = std::string(isSin ? "fixsin_q" : "fixcos_q") + std::to_string(FRAC_Q) + "_" +
+				 std::to_string(iterations) + "_" + std::to_string(reduction);
+	return getOrCreateMathKernel(irModule, kernelName, quantizedType, functionsToInsert,
+				     [&](llvm::IRBuilder<> & builder, llvm::Value * x) {
+					     return emitFixSinCos(builder, x, isSin, iterations, reduction);
+				     });
 }
 
 // A list of global variables to erase after processing
@@ -419,7 +852,7 @@ getOrCreateQuantizedGlobal(Module * module, GlobalVariable & globalVar, Type * q
 	    quantizedName);
 
 	// Set alignment based on bit width
-	switch (BIT_WIDTH)
+	switch (quantizationBitWidth)
 	{
 		case 16:
 			newGlobalVar->setAlignment(llvm::MaybeAlign(2));
@@ -428,7 +861,7 @@ getOrCreateQuantizedGlobal(Module * module, GlobalVariable & globalVar, Type * q
 			newGlobalVar->setAlignment(llvm::MaybeAlign(4));
 			break;
 		default:
-			llvm::errs() << "Unsupported bit width: " << BIT_WIDTH << "\n";
+			llvm::errs() << "Unsupported bit width: " << quantizationBitWidth << "\n";
 			break;
 	}
 
@@ -857,18 +1290,14 @@ handleLoad(Instruction * llvmIrInstruction, Type * quantizedType)
 			//			}
 			// #endif
 
-#ifdef IS_POINTER
-			else if (!isa<GlobalVariable>(pointerOperand))
+			else if (!isa<GlobalVariable>(pointerOperand) && quantizationStore == kNewtonQuantizationStorePointer)
 			{
 				quantizePointer(loadInst, Builder, quantizedType, loadedType);
 			}
-
-#else
 			else if (!isa<GlobalVariable>(pointerOperand))
 			{
 				quantizeMatrixFloat(loadInst, Builder, quantizedType, loadedType);
 			}
-#endif
 		}
 	}
 }
@@ -882,21 +1311,30 @@ handleFAdd(Instruction * inInstruction, Type * quantizedType)
 	Value * op0 = inInstruction->getOperand(0);
 	Value * op1 = inInstruction->getOperand(1);
 
-	// Check if one of the operands is a floating-point constant that needs to be multiplied by FRAC_BASE
+	/*
+	 * Both operands are brought to the smaller of their formats and the result's,
+	 * so neither operand is shifted left, and the sum fits because the result does.
+	 * */
+	int resultFracBits = getFixedPointFormat(inInstruction);
+	int fracBits	   = resultFracBits;
+	if (!isa<llvm::Constant>(op0))
+	{
+		fracBits = std::min(fracBits, getFixedPointFormat(op0));
+	}
+	if (!isa<llvm::Constant>(op1))
+	{
+		fracBits = std::min(fracBits, getFixedPointFormat(op1));
+	}
+
+	// Check if one of the operands is a floating-point constant that needs to be scaled by 2^fracBits
 	if (ConstantFP * constFp = dyn_cast<ConstantFP>(op0))
 	{
-		// Multiply the constant by FRAC_BASE and convert to integer
-		float	constValue     = constFp->getValueAPF().convertToFloat();
-		int64_t quantizedValue = static_cast<int64_t>(round(constValue * FRAC_BASE));
-		op0		       = ConstantInt::get(quantizedType, quantizedValue);
+		op0 = quantizeConstantFP(constFp, quantizedType, fracBits);
 	}
 
 	if (ConstantFP * constFp = dyn_cast<ConstantFP>(op1))
 	{
-		// Multiply the constant by FRAC_BASE and convert to integer
-		float	constValue     = constFp->getValueAPF().convertToFloat();
-		int64_t quantizedValue = static_cast<int64_t>(round(constValue * FRAC_BASE));
-		op1		       = ConstantInt::get(quantizedType, quantizedValue);
+		op1 = quantizeConstantFP(constFp, quantizedType, fracBits);
 	}
 
 	// Check if this instruction has metadata indicating it's quantized
@@ -906,9 +1344,21 @@ handleFAdd(Instruction * inInstruction, Type * quantizedType)
 		return;
 	}
 
+	if (!isa<llvm::Constant>(op0))
+	{
+		op0 = alignFixedPoint(Builder, op0, getFixedPointFormat(op0), fracBits);
+	}
+	if (!isa<llvm::Constant>(op1))
+	{
+		op1 = alignFixedPoint(Builder, op1, getFixedPointFormat(op1), fracBits);
+	}
+
 	// Create fixed-point addition
 	Value * newInst = Builder.CreateNSWAdd(op0, op1);
 	// Value * newInst = Builder.CreateAdd(op0, op1);
+	newInst		= alignFixedPoint(Builder, newInst, fracBits, resultFracBits);
+	takeFixedPointFormat(inInstruction);
+	setFixedPointFormat(newInst, resultFracBits);
 
 	// Replace the original FAdd instruction with the new fixed-point addition
 	inInstruction->replaceAllUsesWith(newInst);
@@ -926,26 +1376,47 @@ handleFSub(Instruction * inInstruction, Type * quantizedType)
 	Value * op0 = inInstruction->getOperand(0);
 	Value * op1 = inInstruction->getOperand(1);
 
-	// Check if one of the operands is a floating-point constant that needs to be multiplied by FRAC_BASE
+	/*
+	 * Both operands are brought to the smaller of their formats and the result's,
+	 * so neither operand is shifted left, and the sum fits because the result does.
+	 * */
+	int resultFracBits = getFixedPointFormat(inInstruction);
+	int fracBits	   = resultFracBits;
+	if (!isa<llvm::Constant>(op0))
+	{
+		fracBits = std::min(fracBits, getFixedPointFormat(op0));
+	}
+	if (!isa<llvm::Constant>(op1))
+	{
+		fracBits = std::min(fracBits, getFixedPointFormat(op1));
+	}
+
+	// Check if one of the operands is a floating-point constant that needs to be scaled by 2^fracBits
 	if (ConstantFP * constFp = dyn_cast<ConstantFP>(op0))
 	{
-		// Multiply the constant by FRAC_BASE and convert to integer
-		float	constValue     = constFp->getValueAPF().convertToFloat();
-		int64_t quantizedValue = static_cast<int64_t>(round(constValue * FRAC_BASE));
-		op0		       = ConstantInt::get(quantizedType, quantizedValue);
+		op0 = quantizeConstantFP(constFp, quantizedType, fracBits);
 	}
 
 	if (ConstantFP * constFp = dyn_cast<ConstantFP>(op1))
 	{
-		// Multiply the constant by FRAC_BASE and convert to integer
-		float	constValue     = constFp->getValueAPF().convertToFloat();
-		int64_t quantizedValue = static_cast<int64_t>(round(constValue * FRAC_BASE));
-		op1		       = ConstantInt::get(quantizedType, quantizedValue);
+		op1 = quantizeConstantFP(constFp, quantizedType, fracBits);
+	}
+
+	if (!isa<llvm::Constant>(op0))
+	{
+		op0 = alignFixedPoint(Builder, op0, getFixedPointFormat(op0), fracBits);
+	}
+	if (!isa<llvm::Constant>(op1))
+	{
+		op1 = alignFixedPoint(Builder, op1, getFixedPointFormat(op1), fracBits);
 	}
 
 	// Create fixed-point subtraction
 	Value * newInst = Builder.CreateNSWSub(op0, op1);
 	// Value * newInst = Builder.CreateSub(op0, op1);
+	newInst		= alignFixedPoint(Builder, newInst, fracBits, resultFracBits);
+	takeFixedPointFormat(inInstruction);
+	setFixedPointFormat(newInst, resultFracBits);
 
 	// Replace the original FSub instruction with the new fixed-point subtraction
 	inInstruction->replaceAllUsesWith(newInst);
@@ -1224,7 +1695,7 @@ simplifyUsingShift(Value * operand, Instruction * instruction, int shiftAmount,
 	// Type *		  intType    = Type::getInt32Ty(instruction->getContext());
 	llvm::Type * intType = nullptr;
 
-	switch (BIT_WIDTH)
+	switch (quantizationBitWidth)
 	{
 		case 16:
 			intType = llvm::Type::getInt16Ty(instruction->getContext());  // Use 16-bit integer type
@@ -1300,6 +1771,9 @@ handleFMul(Instruction * llvmIrInstruction, Type * quantizedType)
 		return;	 // Skip processing this instruction
 	}
 
+	// Every path below replaces the instruction, so drop its format up front
+	int resultFracBits = takeFixedPointFormat(llvmIrInstruction);
+
 	// Ensure operands are correctly converted to fixed-point integers
 	Value * lhs = llvmIrInstruction->getOperand(0);
 	Value * rhs = llvmIrInstruction->getOperand(1);
@@ -1379,7 +1853,14 @@ handleFMul(Instruction * llvmIrInstruction, Type * quantizedType)
 
 
 	{
-		llvm::Value * newInst = performFixedPointMul(Builder, lhs, rhs, FRAC_Q);
+		/*
+		 * the product carries the fraction bits of both operands,
+		 * shift it down (or up) to the format selected for the result.
+		 * */
+		int	      productShift = getFixedPointFormat(lhs) + getFixedPointFormat(rhs) - resultFracBits;
+		llvm::Value * newInst	   = performFixedPointMul(Builder, lhs, rhs, std::max(productShift, 0));
+		newInst			   = alignFixedPoint(Builder, newInst, 0, std::max(-productShift, 0));
+		setFixedPointFormat(newInst, resultFracBits);
 		llvmIrInstruction->replaceAllUsesWith(newInst);
 		llvmIrInstruction->eraseFromParent();
 	}
@@ -1483,6 +1964,7 @@ void handlePhi(Instruction *inInstruction, Type *quantizedType) {
 	Type *newPhiType = isPtr ? quantizedType->getPointerTo(pointerAddr) : quantizedType;
 	PHINode *newPhi = PHINode::Create(newPhiType, phi->getNumIncomingValues(),
 					       phi->getName() + ".quantized", phi);
+	int phiFracBits = takeFixedPointFormat(phi);
 
 	for (unsigned i = 0, e = phi->getNumIncomingValues(); i < e; i++) {
 		Value *incoming = phi->getIncomingValue(i);
@@ -1496,14 +1978,14 @@ void handlePhi(Instruction *inInstruction, Type *quantizedType) {
 				// Check for infinity.
 				if (constFp->getValueAPF().isInfinity()) {
 					int64_t maxVal = 0, minVal = 0;
-					// Choose maximum/minimum based on BIT_WIDTH.
-					if (BIT_WIDTH == 16) {
+					// Choose maximum/minimum based on the bit width.
+					if (quantizationBitWidth == 16) {
 						maxVal = (std::numeric_limits<int16_t>::max)();
 						minVal = (std::numeric_limits<int16_t>::min)();
-					} else if (BIT_WIDTH == 32) {
+					} else if (quantizationBitWidth == 32) {
 						maxVal = (std::numeric_limits<int32_t>::max)();
 						minVal = (std::numeric_limits<int32_t>::min)();
-					} else if (BIT_WIDTH == 64) {
+					} else if (quantizationBitWidth == 64) {
 						maxVal = (std::numeric_limits<int64_t>::max)();
 						minVal = (std::numeric_limits<int64_t>::min)();
 					} else {
@@ -1519,15 +2001,18 @@ void handlePhi(Instruction *inInstruction, Type *quantizedType) {
 						newVal = llvm::ConstantInt::get(quantizedType, minVal, true);
 					}
 				} else {
-					float fpVal = constFp->getValueAPF().convertToFloat();
-					int64_t quantizedValue = static_cast<int64_t>(round(fpVal * FRAC_BASE));
-					newVal = llvm::ConstantInt::get(quantizedType, quantizedValue, true);
+					newVal = quantizeConstantFP(constFp, quantizedType, phiFracBits);
 					llvm::errs() << "Converted constant: " << *newVal << "\n";
 				}
 			} else if (incoming->getType()->isFloatingPointTy()) {
 				IRBuilder<> builder(incomingBB->getTerminator());
 				newVal = builder.CreateFPToSI(incoming, quantizedType, incoming->getName() + ".to_int");
+				newVal = alignFixedPoint(builder, newVal, getFixedPointFormat(incoming), phiFracBits);
 				llvm::errs() << "Inserted conversion: " << *newVal << "\n";
+			} else if (!isa<llvm::Constant>(incoming)) {
+				// align the incoming value at the end of its block, where it is available
+				IRBuilder<> builder(incomingBB->getTerminator());
+				newVal = alignFixedPoint(builder, incoming, getFixedPointFormat(incoming), phiFracBits);
 			} else {
 				newVal = incoming;
 			}
@@ -1543,6 +2028,7 @@ void handlePhi(Instruction *inInstruction, Type *quantizedType) {
 		newPhi->addIncoming(newVal, incomingBB);
 	}
 
+	setFixedPointFormat(newPhi, phiFracBits);
 	phi->replaceAllUsesWith(newPhi);
 	phi->eraseFromParent();
 	llvm::errs() << "Finished handling PHI: " << *newPhi << "\n";
@@ -1741,9 +2227,9 @@ bitcastFloatPtrArgs(Function & F, IRBuilder<> & Builder)
 			Builder.SetInsertPoint(&*F.getEntryBlock().getFirstInsertionPt());
 			Value * i32Arg = Builder.CreateBitCast(&Arg, i32PtrType, Arg.getName() + ".to_i32_ptr");
 
-			// Additional bitcast to i16* if BIT_WIDTH == 16
+			// Additional bitcast to i16* if quantizationBitWidth == 16
 			Value * newArg = nullptr;
-			switch (BIT_WIDTH)
+			switch (quantizationBitWidth)
 			{
 				case 16:
 				{
@@ -1811,11 +2297,18 @@ bitcastFloatPtrArgs(Function & F, IRBuilder<> & Builder)
 }
 
 void
-handleRsqrtCall(CallInst * llvmIrCallInstruction, Type * quantizedType, Function * fixrsqrt)
+handleRsqrtCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert)
 {
 	IRBuilder<> builder(llvmIrCallInstruction);
 	auto	    operand = llvmIrCallInstruction->getOperand(0);
 
+	if (!hasIntegerMathKernels(quantizedType))
+	{
+		llvm::errs() << "Error: no fixed-point rsqrt for this bit width.\n";
+		return;
+	}
+
+	Function * fixrsqrt = createFixRsqrt(llvmIrCallInstruction->getModule(), quantizedType, functionsToInsert, llvmIrCallInstruction);
 	if (!fixrsqrt)
 	{
 		llvm::errs() << "Error: fixrsqrt function is null.\n";
@@ -1869,7 +2362,7 @@ performFixedPointSqrt(IRBuilder<> & builder, Module * irModule, Value * fixedPoi
 }
 
 void
-handleSqrtCall(CallInst * llvmIrCallInstruction, Type * quantizedType)
+handleSqrtCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert)
 {
 	IRBuilder<> Builder(llvmIrCallInstruction);
 	auto	    operand = llvmIrCallInstruction->getOperand(0);
@@ -1881,20 +2374,43 @@ handleSqrtCall(CallInst * llvmIrCallInstruction, Type * quantizedType)
 	}
 
 	// Create call to the fixed-point sqrt function
-	//llvm::Value * sqrtResult = Builder.CreateCall(fixsqrt, {operand});
-	llvm::Value * sqrtResult = performFixedPointSqrt(Builder, llvmIrCallInstruction->getModule(), operand, quantizedType, FRAC_Q, llvmIrCallInstruction->getContext());
+	llvm::Value * sqrtResult = nullptr;
+	if (hasIntegerMathKernels(quantizedType))
+	{
+		llvm::Function * fixsqrt = createFixSqrt(llvmIrCallInstruction->getModule(), quantizedType, functionsToInsert, llvmIrCallInstruction);
+		sqrtResult		 = Builder.CreateCall(fixsqrt, {operand});
+	}
+	else
+	{
+		sqrtResult = performFixedPointSqrt(Builder, llvmIrCallInstruction->getModule(), operand, quantizedType, FRAC_Q, llvmIrCallInstruction->getContext());
+	}
 	// No need to apply shl and compensation if it's already done in createFixSqrt
 	llvmIrCallInstruction->replaceAllUsesWith(sqrtResult);
 	llvmIrCallInstruction->eraseFromParent();
 }
 
 void
-handleSinCosCall(CallInst * llvmIrCallInstruction, Type * quantizedType, const std::string & mathFunc)
+handleSinCosCall(CallInst * llvmIrCallInstruction, Type * quantizedType, const std::string & mathFunc,
+		 std::vector<llvm::Function *> & functionsToInsert)
 {
 	IRBuilder<> builder(llvmIrCallInstruction);
 
 	Value * operand = llvmIrCallInstruction->getOperand(0);
 
+	if (hasIntegerMathKernels(quantizedType))
+	{
+		if (operand->getType()->isFloatingPointTy())
+		{
+			operand = builder.CreateFPToSI(operand, quantizedType);
+		}
+		llvm::Function * fixSinCos = createFixSinCos(llvmIrCallInstruction->getModule(), quantizedType, functionsToInsert,
+							     llvmIrCallInstruction, mathFunc == "sin");
+		Value *		 result	   = builder.CreateCall(fixSinCos, {operand});
+		llvmIrCallInstruction->replaceAllUsesWith(result);
+		llvmIrCallInstruction->eraseFromParent();
+		return;
+	}
+
 	Value * floatOperand = builder.CreateSIToFP(operand, llvm::Type::getFloatTy(llvmIrCallInstruction->getContext()));
 
 	// use float version sin/cos
@@ -1940,7 +2456,7 @@ handleSinCosCall(CallInst * llvmIrCallInstruction, Type * quantizedType, const s
 void
 
 // handleCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert,  llvm::Function * fixrsqrt)
-handleCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert, llvm::Function * fixrsqrt)
+handleCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<llvm::Function *> & functionsToInsert)
 {
 	llvm::errs() << "Handling Call\n";
 	Function * calledFunction = llvmIrCallInstruction->getCalledFunction();
@@ -1956,7 +2472,7 @@ handleCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<l
 		Builder.SetInsertPoint(insertPoint);
 		Value * newInst = nullptr;
 		llvm::errs() << "Handling invsqrt call\n";
-		handleRsqrtCall(llvmIrCallInstruction, quantizedType, fixrsqrt);
+		handleRsqrtCall(llvmIrCallInstruction, quantizedType, functionsToInsert);
 
 		//		functionsToErase.erase(
 		//		    std::remove(functionsToErase.begin(), functionsToErase.end(), fixrsqrt),
@@ -1985,7 +2501,7 @@ handleCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<l
 			if (funcName == "sqrt" || funcName == "sqrtf")
 			{
 				// For sqrt
-				handleSqrtCall(llvmIrCallInstruction, quantizedType);
+				handleSqrtCall(llvmIrCallInstruction, quantizedType, functionsToInsert);
 				if (calledFunction->use_empty())
 				{
 					functionsToErase.push_back(calledFunction);
@@ -1994,12 +2510,12 @@ handleCall(CallInst * llvmIrCallInstruction, Type * quantizedType, std::vector<l
 			else if (funcName == "sin" || funcName == "sinf")
 			{
 				llvm::errs() << "Handling sin call\n";
-				handleSinCosCall(llvmIrCallInstruction, quantizedType, "sin");
+				handleSinCosCall(llvmIrCallInstruction, quantizedType, "sin", functionsToInsert);
 			}
 			else if (funcName == "cos" || funcName == "cosf")
 			{
 				llvm::errs() << "Handling cos call\n";
-				handleSinCosCall(llvmIrCallInstruction, quantizedType, "cos");
+				handleSinCosCall(llvmIrCallInstruction, quantizedType, "cos", functionsToInsert);
 			}
 			//			else
 			//			{
@@ -2097,7 +2613,7 @@ quantizeFunctionArguments(llvm::Function & func, llvm::IRBuilder<> & builder)
 			// llvm::Instruction * quantized = cast<llvm::Instruction>(builder.CreateFPToSI(rounded, llvm::Type::getInt32Ty(arg.getContext()), arg.getName() + ".changed"));
 			llvm::Instruction * quantized = nullptr;
 
-			switch (BIT_WIDTH)
+			switch (quantizationBitWidth)
 			{
 				case 16:
 				{
@@ -2160,6 +2676,20 @@ shouldSkipFunction(const std::string & functionName)
 	    "sqrt",
 	    "sqrtf"};
 
+	// Generated integer math kernels, e.g. fixsqrt_q16_30
+	static const std::vector<std::string> skipPrefixes = {
+	    "fixsqrt_",
+	    "fixrsqrt_",
+	    "fixsin_",
+	    "fixcos_"};
+	for (const auto & prefix : skipPrefixes)
+	{
+		if (functionName.compare(0, prefix.size(), prefix) == 0)
+		{
+			return true;
+		}
+	}
+
 	return skipFunctions.find(functionName) != skipFunctions.end();
 }
 
@@ -2255,12 +2785,13 @@ adaptTypeCast(llvm::Function & llvmIrFunction, Type * quantizedType)
 
 
 void
-irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, std::vector<llvm::Function *> &functionsToInsert,
-
-			     int maxPrecisionBits)
+irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, BoundInfo * boundInfo,
+			     std::vector<llvm::Function *> &functionsToInsert, int maxPrecisionBits)
 {
 	{
-		FRAC_Q = maxPrecisionBits;
+		FRAC_Q		     = maxPrecisionBits;
+		quantizationBitWidth = getQuantizationBitWidth(N);
+		quantizationStore    = getQuantizationStore(N);
 		flexprint(N->Fe, N->Fm, N->Fpinfo, "\tauto quantization.\n");
 		llvm::errs() << "Entering irPassLLVMIRAutoQuantization\n";
 
@@ -2279,7 +2810,7 @@ irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, std::vect
 
 
 		Type * quantizedType;
-		switch (BIT_WIDTH)
+		switch (quantizationBitWidth)
 		{
 			case 8:
 				quantizedType = Type::getInt8Ty(llvmIrFunction.getContext());
@@ -2299,6 +2830,14 @@ irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, std::vect
 				return;
 		}
 
+		/*
+		 * pick the fraction bits of each FAdd/FSub/FMul/PHI from its range,
+		 * before any instruction is replaced.
+		 * */
+		fixedPointFormat.clear();
+		selectFixedPointFormats(llvmIrFunction, boundInfo, quantizationBitWidth, maxPrecisionBits, fixedPointFormat);
+		flexprint(N->Fe, N->Fm, N->Fpinfo, "\t%zu values use a per-value fixed-point format.\n", fixedPointFormat.size());
+
 		// Save the parent module
 		Module * module = llvmIrFunction.getParent();
 		if (!module)
@@ -2313,12 +2852,15 @@ irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, std::vect
 		quantizeArguments(llvmIrFunction, quantizedType);
 
 
-#ifdef IS_POINTER
-		llvm::errs() << "Performing bitcasting for float pointer arguments.\n";
-		bitcastFloatPtrArgs(llvmIrFunction, builder);
-#else
-		llvm::errs() << "Skipping bitcasting for float pointer arguments.\n";
-#endif
+		if (quantizationStore == kNewtonQuantizationStorePointer)
+		{
+			llvm::errs() << "Performing bitcasting for float pointer arguments.\n";
+			bitcastFloatPtrArgs(llvmIrFunction, builder);
+		}
+		else
+		{
+			llvm::errs() << "Skipping bitcasting for float pointer arguments.\n";
+		}
 
 		// Update global variables to integer type
 		updateGlobalVariables(module, quantizedType);
@@ -2326,11 +2868,9 @@ irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, std::vect
 		updateInternalConstants(module, quantizedType);
 
 		/*
-		 * generate hardcode function
+		 * sqrt/rsqrt/sin/cos kernels are generated on demand, sized by the operand interval of each call
 		 * */
-		//llvm::Function * fixsqrt  = createFixSqrt(module, quantizedType, functionsToInsert);
-		llvm::Function * fixrsqrt = createFixRsqrt(module, quantizedType, functionsToInsert);
-		//		functionsToErase.push_back(fixrsqrt);
+		collectMathCallOperandRanges(llvmIrFunction, boundInfo);
 
 		for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
 		{
@@ -2348,7 +2888,7 @@ irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, std::vect
 						break;
 					case Instruction::Call:
 						// handleCall(cast<CallInst>(llvmIrInstruction), quantizedType, functionsToInsert,  fixrsqrt);
-						handleCall(cast<CallInst>(llvmIrInstruction), quantizedType, functionsToInsert, fixrsqrt);
+						handleCall(cast<CallInst>(llvmIrInstruction), quantizedType, functionsToInsert);
 						break;
 					case Instruction::GetElementPtr:
 						handleGetElementPtr(cast<GetElementPtrInst>(llvmIrInstruction), quantizedType);
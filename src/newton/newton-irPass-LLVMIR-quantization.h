@@ -39,8 +39,29 @@ extern std::vector<llvm::Function*> functionsToErase;
 extern std::vector<llvm::GlobalVariable*> globalsToErase;
 //extern std::vector<llvm::Instruction*> instructionsToErase;
 
+/*
+ * the quantization options carried in State, or the config.h defaults where unset.
+ * */
+int
+getQuantizationBitWidth(State * N);
+
+int
+getQuantizationPrecisionBits(State * N);
+
+NewtonQuantizationStore
+getQuantizationStore(State * N);
+
+void
+irPassLLVMIRAutoQuantization(State * N, llvm::Function & llvmIrFunction, BoundInfo * boundInfo,
+			     std::vector<llvm::Function*>& functionsToInsert, int maxPrecisionBits);
+
+/*
+ * select the number of fraction bits of each FAdd/FSub/FMul/PHI in `llvmIrFunction` from its
+ * range in `boundInfo`, for `bitWidth`-bit words. Values that are not in `formats` use `maxPrecisionBits`.
+ * */
 void
-irPassLLVMIRAutoQuantization(State * N, llvm::Function & llvmIrFunction,  std::vector<llvm::Function*>& functionsToInsert,int maxPrecisionBits);
+selectFixedPointFormats(llvm::Function & llvmIrFunction, BoundInfo * boundInfo, int bitWidth, int maxPrecisionBits,
+			std::map<llvm::Value *, int> & formats);
 
 //void
 //irPassLLVMIRAutoQuantization(State *N, llvm::Function &llvmIrFunction, std::vector<llvm::Function *> &functionsToInsert,
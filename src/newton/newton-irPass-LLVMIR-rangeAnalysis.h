@@ -1,125 +1,527 @@
-/*
-	Authored 2022. Pei Mu.
-
-	All rights reserved.
-
-	Redistribution and use in source and binary forms, with or without
-	modification, are permitted provided that the following conditions
-	are met:
-
-	*	Redistributions of source code must retain the above
-		copyright notice, this list of conditions and the following
-		disclaimer.
-
-	*	Redistributions in binary form must reproduce the above
-		copyright notice, this list of conditions and the following
-		disclaimer in the documentation and/or other materials
-		provided with the distribution.
-
-	*	Neither the name of the author nor the names of its
-		contributors may be used to endorse or promote products
-		derived from this software without specific prior written
-		permission.
-
-	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
-	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
-	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
-	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
-	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
-	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
-	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
-	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-	POSSIBILITY OF SUCH DAMAGE.
-*/
-#ifndef NEWTON_IR_PASS_LLVM_IR_RANGE_ANALYSIS
-#define NEWTON_IR_PASS_LLVM_IR_RANGE_ANALYSIS
-
-#include <algorithm>
-#include <assert.h>
-#include <bitset>
-#include <numeric>
-#include <cmath>
-#include <float.h>
-#include <limits>
-#include <regex>
-#include <stdio.h>
-#include <stdlib.h>
-#include <setjmp.h>
-#include <stdint.h>
-#include <string.h>
-#include <set>
-#include <map>
-#include <string>
-#include <unordered_set>
-#include <unordered_map>
-#include <vector>
-
-#include "llvm/Analysis/MemorySSAUpdater.h"
-#include "llvm/Bitcode/BitcodeWriter.h"
-#include "llvm/IR/Constant.h"
-#include "llvm/IR/DebugInfoMetadata.h"
-#include "llvm/IR/LegacyPassManager.h"
-#include "llvm/IR/Metadata.h"
-#include "llvm/IR/Module.h"
-#include "llvm/IR/IRBuilder.h"
-#include "llvm/IR/Instructions.h"
-#include "llvm/IR/InstIterator.h"
-#include "llvm/IR/IntrinsicInst.h"
-#include "llvm/IR/Value.h"
-#include "llvm/IRReader/IRReader.h"
-#include "llvm/Support/SourceMgr.h"
-#include "llvm/Support/raw_ostream.h"
-#include "llvm/Support/Path.h"
-#include "llvm/Transforms/IPO.h"
-#include "llvm/Transforms/Scalar.h"
-#include "llvm/Transforms/Utils/BasicBlockUtils.h"
-#include "llvm/Transforms/Utils/Cloning.h"
-#include "llvm/Transforms/Utils/FunctionComparator.h"
-
-#ifdef __cplusplus
-extern "C" {
-#endif /* __cplusplus */
-
-#include "flextypes.h"
-#include "flexerror.h"
-#include "flex.h"
-#include "common-errors.h"
-#include "version.h"
-#include "newton-timeStamps.h"
-#include "common-timeStamps.h"
-#include "common-data-structures.h"
-#include "noisy-parser.h"
-#include "newton-parser.h"
-#include "noisy-lexer.h"
-#include "newton-lexer.h"
-#include "common-irPass-helpers.h"
-#include "common-lexers-helpers.h"
-#include "common-irHelpers.h"
-#include "common-symbolTable.h"
-#include "newton-types.h"
-#include "newton-symbolTable.h"
-#include "newton-irPass-cBackend.h"
-#include "newton-irPass-autoDiff.h"
-#include "newton-irPass-estimatorSynthesisBackend.h"
-#include "newton-irPass-invariantSignalAnnotation.h"
-
-typedef struct BoundInfo {
-	std::map<llvm::Value *, std::pair<double, double>> virtualRegisterRange;
-	std::map<std::string, BoundInfo *>		   calleeBound;
-} BoundInfo;
-
-std::pair<llvm::Value *, std::pair<double, double>>
-rangeAnalysis(State * N, llvm::Function & llvmIrFunction, BoundInfo * boundInfo,
-	      std::map<std::string, llvm::CallInst *> &				      callerMap,
-	      const std::map<std::string, std::pair<double, double>> &		      typeRange,
-	      const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
-	      bool								      overLoadFunc);
-
-#ifdef __cplusplus
-} /* extern "C" */
-#endif /* __cplusplus */
-
-#endif /* NEWTON_IR_PASS_LLVM_IR_RANGE_ANALYSIS */
+/*
+	Authored 2022. Pei Mu.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef NEWTON_IR_PASS_LLVM_IR_RANGE_ANALYSIS
+#define NEWTON_IR_PASS_LLVM_IR_RANGE_ANALYSIS
+
+#include <algorithm>
+#include <assert.h>
+#include <bitset>
+#include <numeric>
+#include <cmath>
+#include <float.h>
+#include <limits>
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <set>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <unordered_map>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/MemorySSAUpdater.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Constant.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Value.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Transforms/IPO.h"
+#include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/FunctionComparator.h"
+
+/*
+ * The value ranges of one function. Each value gets a dense slot number the first
+ * time it is recorded, and its interval lives in a flat array of records indexed by
+ * that slot, so lookups are a single hash probe instead of a walk down a std::map.
+ * Iterators hold the slot rather than an address, which keeps them valid while the
+ * table grows, the same as the std::map iterators the passes were written against.
+ *
+ * The ranges of the module's global variables are kept in a separate table that is
+ * shared, read-only, by every function (`setGlobalLayer`). A lookup that misses the
+ * function's own slots falls through to it and copies the record into a local slot,
+ * so an update to a global inside one function stays local to that function.
+ * Erased values keep their slot as a tombstone so they do not reappear from the
+ * global layer.
+ * */
+class RangeTable {
+	public:
+	using key_type	  = llvm::Value *;
+	using mapped_type = std::pair<double, double>;
+	using value_type  = std::pair<llvm::Value *, std::pair<double, double>>;
+
+	enum : size_t { NoSlot = ~(size_t)0 };
+
+	template <typename Table, typename Record>
+	class SlotIterator {
+		public:
+		SlotIterator(Table * table, size_t slot) : table(table), slot(slot) {}
+		template <typename OtherTable, typename OtherRecord>
+		SlotIterator(const SlotIterator<OtherTable, OtherRecord> & other) : table(other.table), slot(other.slot) {}
+
+		Record & operator*() const { return table->records[slot]; }
+		Record * operator->() const { return &table->records[slot]; }
+		SlotIterator & operator++()
+		{
+			slot = table->nextLiveSlot(slot + 1);
+			return *this;
+		}
+		template <typename OtherTable, typename OtherRecord>
+		bool operator==(const SlotIterator<OtherTable, OtherRecord> & other) const
+		{
+			return slot == other.slot && (slot == NoSlot || table == other.table);
+		}
+		template <typename OtherTable, typename OtherRecord>
+		bool operator!=(const SlotIterator<OtherTable, OtherRecord> & other) const
+		{
+			return !(*this == other);
+		}
+
+		private:
+		template <typename, typename>
+		friend class SlotIterator;
+		friend class RangeTable;
+		Table * table;
+		size_t	slot;
+	};
+	using iterator	     = SlotIterator<RangeTable, value_type>;
+	using const_iterator = SlotIterator<const RangeTable, const value_type>;
+
+	iterator       begin() { return iterator(this, nextLiveSlot(0)); }
+	iterator       end() { return iterator(this, NoSlot); }
+	const_iterator begin() const { return const_iterator(this, nextLiveSlot(0)); }
+	const_iterator end() const { return const_iterator(this, NoSlot); }
+
+	iterator
+	find(llvm::Value * value)
+	{
+		return iterator(this, lookupSlot(value));
+	}
+
+	/*
+	 * The read-only lookup does not copy from the global layer, so it may return an
+	 * iterator into the global table.
+	 * */
+	const_iterator
+	find(llvm::Value * value) const
+	{
+		auto slotIt = slots.find(value);
+		if (slotIt != slots.end())
+		{
+			return isLive(slotIt->second) ? const_iterator(this, slotIt->second) : end();
+		}
+		if (globalLayer != nullptr)
+		{
+			auto globalIt = globalLayer->find(value);
+			if (globalIt != globalLayer->end())
+			{
+				return globalIt;
+			}
+		}
+		return end();
+	}
+
+	size_t
+	count(llvm::Value * value) const
+	{
+		return find(value) != end() ? 1 : 0;
+	}
+
+	/*
+	 * Same contract as std::map::emplace: an existing range is never overwritten.
+	 * `range` is taken by value because callers pass references into this table.
+	 * */
+	std::pair<iterator, bool>
+	emplace(llvm::Value * value, std::pair<double, double> range)
+	{
+		size_t slot = lookupSlot(value);
+		if (slot != NoSlot)
+		{
+			return std::make_pair(iterator(this, slot), false);
+		}
+		return std::make_pair(iterator(this, assignSlot(value, range)), true);
+	}
+
+	std::pair<iterator, bool>
+	insert(const value_type & record)
+	{
+		return emplace(record.first, record.second);
+	}
+
+	std::pair<double, double> &
+	operator[](llvm::Value * value)
+	{
+		size_t slot = lookupSlot(value);
+		if (slot == NoSlot)
+		{
+			slot = assignSlot(value, std::pair<double, double>());
+		}
+		return records[slot].second;
+	}
+
+	void
+	erase(iterator position)
+	{
+		records[position.slot].first = nullptr;
+		liveRecords--;
+	}
+
+	size_t
+	erase(llvm::Value * value)
+	{
+		auto it = find(value);
+		if (it == end())
+		{
+			return 0;
+		}
+		erase(it);
+		return 1;
+	}
+
+	size_t
+	size() const
+	{
+		return liveRecords;
+	}
+
+	bool
+	empty() const
+	{
+		return liveRecords == 0;
+	}
+
+	void
+	reserve(size_t numValues)
+	{
+		slots.reserve(numValues);
+		records.reserve(numValues);
+	}
+
+	void
+	setGlobalLayer(const RangeTable * layer)
+	{
+		globalLayer = layer;
+	}
+
+	const RangeTable *
+	getGlobalLayer() const
+	{
+		return globalLayer;
+	}
+
+	private:
+	bool
+	isLive(size_t slot) const
+	{
+		return records[slot].first != nullptr;
+	}
+
+	size_t
+	nextLiveSlot(size_t slot) const
+	{
+		while (slot < records.size() && !isLive(slot))
+		{
+			slot++;
+		}
+		return slot < records.size() ? slot : NoSlot;
+	}
+
+	/*
+	 * Slot of a live record for `value`, pulling it in from the global layer if needed.
+	 * */
+	size_t
+	lookupSlot(llvm::Value * value)
+	{
+		auto slotIt = slots.find(value);
+		if (slotIt != slots.end())
+		{
+			return isLive(slotIt->second) ? slotIt->second : NoSlot;
+		}
+		if (globalLayer != nullptr)
+		{
+			auto globalIt = globalLayer->find(value);
+			if (globalIt != globalLayer->end())
+			{
+				return assignSlot(value, globalIt->second);
+			}
+		}
+		return NoSlot;
+	}
+
+	size_t
+	assignSlot(llvm::Value * value, const std::pair<double, double> & range)
+	{
+		auto slotIt = slots.find(value);
+		if (slotIt != slots.end())
+		{
+			records[slotIt->second] = std::make_pair(value, range);
+			liveRecords++;
+			return slotIt->second;
+		}
+		size_t slot = records.size();
+		slots[value] = slot;
+		records.emplace_back(value, range);
+		liveRecords++;
+		return slot;
+	}
+
+	llvm::DenseMap<const llvm::Value *, size_t> slots;
+	std::vector<value_type>			    records;
+	size_t					    liveRecords = 0;
+	const RangeTable *			    globalLayer = nullptr;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "flextypes.h"
+#include "flexerror.h"
+#include "flex.h"
+#include "common-errors.h"
+#include "version.h"
+#include "newton-timeStamps.h"
+#include "common-timeStamps.h"
+#include "common-data-structures.h"
+#include "noisy-parser.h"
+#include "newton-parser.h"
+#include "noisy-lexer.h"
+#include "newton-lexer.h"
+#include "common-irPass-helpers.h"
+#include "common-lexers-helpers.h"
+#include "common-irHelpers.h"
+#include "common-symbolTable.h"
+#include "newton-types.h"
+#include "newton-symbolTable.h"
+#include "newton-irPass-cBackend.h"
+#include "newton-irPass-autoDiff.h"
+#include "newton-irPass-estimatorSynthesisBackend.h"
+#include "newton-irPass-invariantSignalAnnotation.h"
+
+class RangeSummaryCache;
+
+typedef struct BoundInfo {
+	RangeTable			   virtualRegisterRange;
+	std::map<std::string, BoundInfo *> calleeBound;
+	RangeSummaryCache *		   summaryCache = nullptr;
+} BoundInfo;
+
+/*
+ * Memoized results of analyzing a callee, keyed by the callee and the ranges of its
+ * arguments (an empty interval for an argument without a range). A summary holds the
+ * range of the return value and the callee's BoundInfo, whose entries are merged into
+ * the caller, e.g. the ranges stored through pointer arguments. The cache owns the
+ * BoundInfo of every summary; summaries are never modified once recorded.
+ *
+ * Like RangeTable, a cache may sit on top of a read-only parent: a worker of the
+ * parallel driver records into its own cache, reads the summaries published by
+ * earlier waves through the parent, and its entries are `absorb`ed into the parent
+ * after the wave. The key of a callee that is being analyzed is marked in progress
+ * so a recursive call with the same arguments does not recurse again.
+ *
+ * The cache also keeps the specializations made by overloading, keyed by the callee
+ * and the quantized ranges of its arguments, so that call sites share a clone instead
+ * of each making their own. Overloading mutates the module and only runs in the
+ * sequential driver.
+ * */
+class RangeSummaryCache {
+	public:
+	using Key = std::pair<llvm::Function *, std::vector<std::pair<double, double>>>;
+
+	struct Summary {
+		std::pair<llvm::Value *, std::pair<double, double>> returnRange;
+		BoundInfo *					    calleeBoundInfo;
+	};
+
+	/*
+	 * A clone of a callee specialized for a tuple of quantized argument ranges. Its
+	 * BoundInfo is also recorded in the callers' calleeBound, so it is not owned here.
+	 * */
+	struct Specialization {
+		llvm::Function *				    function;
+		BoundInfo *					    boundInfo;
+		std::pair<llvm::Value *, std::pair<double, double>> returnRange;
+	};
+
+	RangeSummaryCache(const RangeSummaryCache * parent = nullptr) : parent(parent) {}
+	RangeSummaryCache(const RangeSummaryCache &)		 = delete;
+	RangeSummaryCache & operator=(const RangeSummaryCache &) = delete;
+
+	~RangeSummaryCache()
+	{
+		for (auto & summary : summaries)
+		{
+			delete summary.second.calleeBoundInfo;
+		}
+	}
+
+	const Summary *
+	find(const Key & key) const
+	{
+		auto summaryIt = summaries.find(key);
+		if (summaryIt != summaries.end())
+		{
+			return &summaryIt->second;
+		}
+		return parent != nullptr ? parent->find(key) : nullptr;
+	}
+
+	/*
+	 * Record a summary and take ownership of its BoundInfo. If the key already has a
+	 * summary, the new one is dropped and the recorded one is returned.
+	 * */
+	const Summary &
+	emplace(const Key & key, const Summary & summary)
+	{
+		auto summaryIt = summaries.emplace(key, summary);
+		if (!summaryIt.second)
+		{
+			delete summary.calleeBoundInfo;
+		}
+		return summaryIt.first->second;
+	}
+
+	const Specialization *
+	findSpecialization(const Key & key) const
+	{
+		auto specializationIt = specializations.find(key);
+		if (specializationIt != specializations.end())
+		{
+			return &specializationIt->second;
+		}
+		return parent != nullptr ? parent->findSpecialization(key) : nullptr;
+	}
+
+	/*
+	 * Record the specialization of `key.first`. It is recorded before the clone is
+	 * analyzed, so a recursive call finds it, and its return range is filled in after.
+	 * */
+	Specialization &
+	recordSpecialization(const Key & key, const Specialization & specialization)
+	{
+		specializationBase[specialization.function] = key.first;
+		specializationsOf[key.first].emplace_back(specialization.function);
+		return specializations.emplace(key, specialization).first->second;
+	}
+
+	/*
+	 * The function that `llvmIrFunction` was specialized from, or itself.
+	 * */
+	llvm::Function *
+	getBaseFunction(llvm::Function * llvmIrFunction) const
+	{
+		auto baseIt = specializationBase.find(llvmIrFunction);
+		if (baseIt != specializationBase.end())
+		{
+			return baseIt->second;
+		}
+		return parent != nullptr ? parent->getBaseFunction(llvmIrFunction) : llvmIrFunction;
+	}
+
+	const std::vector<llvm::Function *> &
+	getSpecializations(llvm::Function * baseFunction)
+	{
+		return specializationsOf[baseFunction];
+	}
+
+	bool
+	enter(const Key & key)
+	{
+		return inProgress.insert(key).second;
+	}
+
+	void
+	leave(const Key & key)
+	{
+		inProgress.erase(key);
+	}
+
+	void
+	absorb(RangeSummaryCache & other)
+	{
+		for (auto & summary : other.summaries)
+		{
+			emplace(summary.first, summary.second);
+		}
+		other.summaries.clear();
+	}
+
+	size_t
+	size() const
+	{
+		return summaries.size();
+	}
+
+	private:
+	std::map<Key, Summary>					   summaries;
+	std::map<Key, Specialization>				   specializations;
+	std::map<llvm::Function *, llvm::Function *>		   specializationBase;
+	std::map<llvm::Function *, std::vector<llvm::Function *>> specializationsOf;
+	std::set<Key>						   inProgress;
+	const RangeSummaryCache *				   parent;
+};
+
+std::pair<llvm::Value *, std::pair<double, double>>
+rangeAnalysis(State * N, llvm::Function & llvmIrFunction, BoundInfo * boundInfo,
+	      std::map<std::string, llvm::CallInst *> &				      callerMap,
+	      const std::map<std::string, std::pair<double, double>> &		      typeRange,
+	      const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+	      bool								      overLoadFunc);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* NEWTON_IR_PASS_LLVM_IR_RANGE_ANALYSIS */